@@ -15,4 +15,36 @@ global _get_EFLAGS
 _get_EFLAGS:
 	pushfd			; push eflags
 	pop	eax		; pop contents into eax
-	ret
\ No newline at end of file
+	ret
+
+; ----------------------------------------------------------------------
+; read_tsc()
+;
+; Returns the 64-bit time-stamp counter in edx:eax.
+;
+; ----------------------------------------------------------------------
+global _read_tsc
+; this function is exported.
+_read_tsc:
+	rdtsc			; edx:eax = time-stamp counter
+	ret
+
+; ----------------------------------------------------------------------
+; bit_scan_forward(unsigned int _val)
+; bit_scan_reverse(unsigned int _val)
+;
+; Return the index of the lowest/highest set bit of _val (BSF/BSR).
+; The result is undefined if _val is 0.
+;
+; ----------------------------------------------------------------------
+global _bit_scan_forward
+; this function is exported.
+_bit_scan_forward:
+	bsf	eax, [esp+4]	; eax = index of lowest set bit
+	ret
+
+global _bit_scan_reverse
+; this function is exported.
+_bit_scan_reverse:
+	bsr	eax, [esp+4]	; eax = index of highest set bit
+	ret
@@ -15,4 +15,50 @@ global _get_EFLAGS
 _get_EFLAGS:
 	pushfd			; push eflags
 	pop	eax		; pop contents into eax
-	ret
\ No newline at end of file
+	ret
+
+; ----------------------------------------------------------------------
+; read_tsc()
+;
+; Returns the 64-bit time-stamp counter in edx:eax.
+;
+; ----------------------------------------------------------------------
+global _read_tsc
+; this function is exported.
+_read_tsc:
+	rdtsc			; edx:eax = time-stamp counter
+	ret
+
+; ----------------------------------------------------------------------
+; bit_scan_forward(unsigned int _val)
+; bit_scan_reverse(unsigned int _val)
+;
+; Return the index of the lowest/highest set bit of _val (BSF/BSR).
+; The result is undefined if _val is 0.
+;
+; ----------------------------------------------------------------------
+global _bit_scan_forward
+; this function is exported.
+_bit_scan_forward:
+	bsf	eax, [esp+4]	; eax = index of lowest set bit
+	ret
+
+global _bit_scan_reverse
+; this function is exported.
+_bit_scan_reverse:
+	bsr	eax, [esp+4]	; eax = index of highest set bit
+	ret
+
+; ----------------------------------------------------------------------
+; fetch_and_add(unsigned long * _p, unsigned long _val)
+;
+; Atomically adds _val to *_p and returns the previous value of *_p.
+;
+; ----------------------------------------------------------------------
+global _fetch_and_add
+; this function is exported.
+_fetch_and_add:
+	mov	edx, [esp+4]	; edx = _p
+	mov	eax, [esp+8]	; eax = _val
+	lock xadd [edx], eax	; *_p += _val, eax = old *_p
+	ret
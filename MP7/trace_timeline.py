@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+#
+# File: trace_timeline.py
+#
+# Turns the trace dumps that the kernel writes to the debug port 0xE9
+# (see Trace::dump() in trace.C) into a timeline. Every dump holds the
+# events recorded since the previous one, so all dumps in the input are
+# merged.
+#
+# Capture the dumps with "port_e9_hack: enabled=1" in bochsrc.bxrc, which
+# sends it to the terminal of Bochs, or with "qemu -debugcon file:trace.txt".
+#
+# Usage: trace_timeline.py [--mhz MHZ] [--chrome OUT.json] DUMP
+#
+#   --mhz MHZ         TSC frequency, to print times in microseconds instead
+#                     of cycles.
+#   --chrome OUT.json also write the events in the Chrome trace event format,
+#                     which chrome://tracing and Perfetto display as a timeline.
+#
+
+import argparse
+import json
+import struct
+import sys
+
+# Layout of struct trace_event in trace.H, 24 bytes, little endian.
+EVENT_FORMAT = "<QHHLLL"
+EVENT_SIZE = struct.calcsize(EVENT_FORMAT)
+
+
+def parse_dump(lines):
+    """Returns the type names, the number of events recorded and lost per
+    CPU, and the events of all dumps in the input. Every dump holds the
+    events recorded since the previous one."""
+    types = {}
+    recorded = {}
+    lost = {}
+    events = []
+    for line in lines:
+        fields = line.split()
+        if not fields:
+            continue
+        if fields[0] == "TYPE" and len(fields) == 3:
+            types[int(fields[1], 16)] = fields[2]
+        elif fields[0] == "CPU" and len(fields) == 4:
+            cpu, head, first = (int(field, 16) for field in fields[1:])
+            # Events between the previous dump and this one that the ring overwrote.
+            lost[cpu] = lost.get(cpu, 0) + first - recorded.get(cpu, 0)
+            recorded[cpu] = head
+        elif fields[0] == "EVENT" and len(fields) == 2:
+            data = bytes.fromhex(fields[1])
+            if len(data) != EVENT_SIZE:
+                continue
+            timestamp, type_no, cpu, duration, arg0, arg1 = struct.unpack(EVENT_FORMAT, data)
+            events.append({
+                "timestamp": timestamp,
+                "type": types.get(type_no, str(type_no)),
+                "cpu": cpu,
+                "duration": duration,
+                "arg0": arg0,
+                "arg1": arg1,
+            })
+    events.sort(key=lambda event: event["timestamp"])
+    return types, recorded, lost, events
+
+
+def print_timeline(events, recorded, lost, mhz):
+    if not events:
+        print("no trace events found")
+        return
+
+    unit = "us" if mhz else "cycles"
+    scale = (1.0 / mhz) if mhz else 1.0
+    for cpu, n_recorded in sorted(recorded.items()):
+        print("cpu %d: %d events recorded, %d lost to ring overflow" % (cpu, n_recorded, lost[cpu]))
+
+    start = events[0]["timestamp"]
+    print("%14s %3s %-16s %12s  %-10s %-10s" % ("time(" + unit + ")", "cpu", "event",
+                                                 "duration", "arg0", "arg1"))
+    for event in events:
+        print("%14.2f %3d %-16s %12s  0x%08x 0x%08x" % (
+            (event["timestamp"] - start) * scale, event["cpu"], event["type"],
+            "%.2f" % (event["duration"] * scale) if event["duration"] else "-",
+            event["arg0"], event["arg1"]))
+
+    print()
+    print("%-16s %8s %14s %14s" % ("event", "count", "total(" + unit + ")", "max(" + unit + ")"))
+    summary = {}
+    for event in events:
+        count, total, longest = summary.get(event["type"], (0, 0, 0))
+        summary[event["type"]] = (count + 1, total + event["duration"],
+                                  max(longest, event["duration"]))
+    for name, (count, total, longest) in sorted(summary.items()):
+        print("%-16s %8d %14.2f %14.2f" % (name, count, total * scale, longest * scale))
+
+
+def write_chrome_trace(events, mhz, path):
+    # Chrome traces are in microseconds; without a frequency, one cycle is one unit.
+    scale = (1.0 / mhz) if mhz else 1.0
+    start = events[0]["timestamp"] if events else 0
+    trace = []
+    for event in events:
+        entry = {
+            "name": event["type"],
+            "pid": 0,
+            "tid": event["cpu"],
+            "ts": (event["timestamp"] - start) * scale,
+            "args": {"arg0": hex(event["arg0"]), "arg1": hex(event["arg1"])},
+        }
+        if event["duration"]:
+            entry["ph"] = "X"
+            entry["dur"] = event["duration"] * scale
+        else:
+            entry["ph"] = "i"
+            entry["s"] = "t"
+        trace.append(entry)
+    with open(path, "w") as out:
+        json.dump({"traceEvents": trace}, out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Turn a kernel trace dump into a timeline.")
+    parser.add_argument("dump", help="file with the output of the debug port, - for stdin")
+    parser.add_argument("--mhz", type=float, default=None, help="TSC frequency in MHz")
+    parser.add_argument("--chrome", metavar="OUT.json", help="write a Chrome trace")
+    args = parser.parse_args()
+
+    if args.dump == "-":
+        lines = sys.stdin.read().splitlines()
+    else:
+        with open(args.dump, errors="replace") as dump:
+            lines = dump.read().splitlines()
+
+    types, recorded, lost, events = parse_dump(lines)
+    print_timeline(events, recorded, lost, args.mhz)
+    if args.chrome:
+        write_chrome_trace(events, args.mhz, args.chrome)
+
+
+if __name__ == "__main__":
+    main()